@@ -0,0 +1,62 @@
+"""Put the benchmark and memory results of each allocator side by side.
+
+Usage: allocator_report.py <results-dir> <allocator>...
+
+Reads benchmark-<runner>[-<allocator>].json and memory-<runner>[-<allocator>].json
+from <results-dir>; the first allocator is the baseline and has no suffix.
+Prints one markdown table per result kind and runner.
+"""
+import glob
+import json
+import os
+import sys
+
+KINDS = (
+    ("benchmark", "Mean latency", "mean", lambda v: "%.3g s" % v),
+    ("memory", "Peak RSS", "peak_rss", lambda v: "%.1f MiB" % (v / float(1 << 20))),
+    ("memory", "Allocations", "allocations", lambda v: "{:,}".format(v)),
+)
+
+
+def load(results_dir, kind, allocators):
+    """Return {runner: {allocator: benchmarks}} for one result kind."""
+    baseline = allocators[0]
+    found = {}
+    for path in glob.glob(os.path.join(results_dir, kind + "-*.json")):
+        name = os.path.basename(path)[len(kind) + 1 : -len(".json")]
+        runner, allocator = name, baseline
+        for candidate in allocators[1:]:
+            if name.endswith("-" + candidate):
+                runner, allocator = name[: -len(candidate) - 1], candidate
+        with open(path) as f:
+            found.setdefault(runner, {})[allocator] = json.load(f)["benchmarks"]
+    return found
+
+
+def main(results_dir, *allocators):
+    baseline = allocators[0]
+    for kind, label, metric, fmt in KINDS:
+        for runner, by_allocator in sorted(load(results_dir, kind, allocators).items()):
+            present = [a for a in allocators if a in by_allocator]
+            print("## %s on %s" % (label, runner))
+            print()
+            print("| Benchmark | " + " | ".join(present) + " |")
+            print("|---|" + "---:|" * len(present))
+            names = sorted(set().union(*(by_allocator[a] for a in present)))
+            for name in names:
+                base = by_allocator.get(baseline, {}).get(name, {}).get(metric)
+                cells = []
+                for allocator in present:
+                    value = by_allocator[allocator].get(name, {}).get(metric)
+                    if value is None:
+                        cells.append("n/a")
+                    elif allocator == baseline or not base:
+                        cells.append(fmt(value))
+                    else:
+                        cells.append("%s (%+.1f%%)" % (fmt(value), (value - base) / base * 100.0))
+                print("| `%s` | %s |" % (name, " | ".join(cells)))
+            print()
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
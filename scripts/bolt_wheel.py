@@ -0,0 +1,102 @@
+"""Optimize the code layout of a wheel's extension modules with BOLT.
+
+Usage: bolt_wheel.py <project> <wheel>
+
+Installs the unrepaired wheel into a scratch directory, profiles the
+training workload (<project>/.retrace-ci/profile_workload.sh) against it
+with `perf record`, and rewrites every extension module that collected
+samples with llvm-bolt. Branch records (-j any) are used when the CPU
+exposes them, then plain cycle samples, then the cpu-clock software event,
+which works on VMs without a PMU. Fails when the workload fails or when no
+module could be optimized. The wheel is rewritten in place and still has to
+be repaired afterwards.
+"""
+import os
+import subprocess
+import sys
+import tempfile
+import zipfile
+
+from wheel_files import rewrite_wheel, split_ext
+
+LLVM_BOLT = os.environ.get("LLVM_BOLT", "llvm-bolt")
+PERF2BOLT = os.environ.get("PERF2BOLT", "perf2bolt")
+
+BOLT_OPTIONS = [
+    "-reorder-blocks=ext-tsp",
+    "-reorder-functions=hfsort",
+    "-split-functions",
+    "-split-all-cold",
+    "-split-eh",
+    "-icf=1",
+    "-use-gnu-stack",
+    "-dyno-stats",
+    # Rewrites the DWARF for moved and split functions, so the debug info
+    # split off afterwards (build_profiling) still symbolizes the code
+    "-update-debug-sections",
+]
+
+
+# (perf record arguments, whether they include branch records), best first
+PROFILES = (
+    (["-e", "cycles:u", "-j", "any,u"], True),
+    (["-e", "cycles:u"], False),
+    (["-e", "cpu-clock"], False),
+)
+
+
+def perf_profile():
+    for args, lbr in PROFILES:
+        probe = ["perf", "record"] + args + ["-o", os.devnull, "--", "true"]
+        if subprocess.run(probe, capture_output=True).returncode == 0:
+            return args, lbr
+    sys.exit("perf cannot record samples on this machine")
+
+
+def main(project, wheel):
+    with zipfile.ZipFile(wheel) as zf:
+        modules = [name for name in zf.namelist() if split_ext(name)]
+    if not modules:
+        print("no extension modules in %s, skipping BOLT" % wheel)
+        return
+
+    with tempfile.TemporaryDirectory() as tmp:
+        site = os.path.join(tmp, "site")
+        subprocess.run(
+            [sys.executable, "-m", "pip", "install", "--no-deps", "--target", site, wheel],
+            check=True,
+        )
+
+        args, lbr = perf_profile()
+        print("profiling with perf record %s" % " ".join(args))
+        perf_data = os.path.join(tmp, "perf.data")
+        cmd = ["perf", "record"] + args + ["-o", perf_data]
+        cmd += ["--", "sh", os.path.join(project, ".retrace-ci", "profile_workload.sh")]
+        if subprocess.run(cmd, cwd=project, env=dict(os.environ, PYTHONPATH=site)).returncode:
+            sys.exit("BOLT training workload failed")
+
+        optimized = {}
+        for name in modules:
+            binary = os.path.join(site, name)
+            fdata = binary + ".fdata"
+            cmd = [PERF2BOLT, "-p", perf_data, "-o", fdata, binary]
+            if not lbr:
+                cmd.append("-nl")
+            subprocess.run(cmd, check=True)
+            if not os.path.exists(fdata) or not os.path.getsize(fdata):
+                print("::warning::no profile for %s, leaving it as built" % name)
+                continue
+            subprocess.run(
+                [LLVM_BOLT, binary, "-o", binary + ".bolt", "-data=" + fdata] + BOLT_OPTIONS,
+                check=True,
+            )
+            with open(binary + ".bolt", "rb") as f:
+                optimized[name] = f.read()
+
+    if not optimized:
+        sys.exit("BOLT got no profile for any extension module in %s" % wheel)
+    rewrite_wheel(wheel, optimized)
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,37 @@
+# Sourced by the jobs that build the extension: sets SETUP_ARGS (meson -D
+# options), CFLAGS, CXXFLAGS and LDFLAGS from the BUILD_DEBUG,
+# BUILD_PROFILING, BUILD_LTO and ALLOCATOR inputs and the flag sets in the
+# workflow env, so every job builds the extension the way the wheels are.
+# Usage: . build_flags.sh
+SETUP_ARGS=""
+CFLAGS=""
+CXXFLAGS=""
+LDFLAGS=""
+if [ "$BUILD_DEBUG" = "true" ]; then
+  SETUP_ARGS="-Dbuildtype=debug"
+elif [ "$BUILD_PROFILING" = "true" ]; then
+  SETUP_ARGS="-Dbuildtype=debugoptimized"
+  CFLAGS="$PROFILING_CFLAGS"
+  CXXFLAGS="$PROFILING_CFLAGS"
+  if [ "$RUNNER_OS" = "Linux" ]; then
+    # Debug files are published under the build-id
+    LDFLAGS="-Wl,--build-id=sha1"
+  fi
+fi
+
+case "$ALLOCATOR" in
+  system) ;;
+  mimalloc) SETUP_ARGS="$SETUP_ARGS -Dallocator=$ALLOCATOR" ;;
+  *) echo "::error::unknown allocator '$ALLOCATOR'"; exit 1 ;;
+esac
+
+if [ "$BUILD_LTO" = "true" ] && [ "$BUILD_DEBUG" != "true" ]; then
+  SETUP_ARGS="$SETUP_ARGS $LTO_SETUP_ARGS"
+  CFLAGS="$CFLAGS $LTO_CFLAGS"
+  CXXFLAGS="$CXXFLAGS $LTO_CXXFLAGS"
+  if [ "$RUNNER_OS" = "Linux" ]; then
+    # Mach-O has no ELF interposition to opt out of
+    CFLAGS="$CFLAGS -fno-semantic-interposition"
+    CXXFLAGS="$CXXFLAGS -fno-semantic-interposition"
+  fi
+fi
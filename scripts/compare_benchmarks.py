@@ -0,0 +1,62 @@
+"""Compare two benchmark result files and report regressions.
+
+Usage: compare_benchmarks.py <current.json> <previous.json|-> <throughput-pct> <latency-pct>
+
+Prints a markdown report. Exits with status 1 when any benchmark lost more
+than <throughput-pct> percent of its throughput or gained more than
+<latency-pct> percent of mean latency against the previous results.
+"""
+import json
+import sys
+
+
+def load(path):
+    if path == "-":
+        return {}
+    with open(path) as f:
+        return json.load(f)["benchmarks"]
+
+
+def change(current, previous):
+    return (current - previous) / previous * 100.0 if previous else 0.0
+
+
+def main(current_path, previous_path, throughput_pct, latency_pct):
+    current = load(current_path)
+    previous = load(previous_path)
+    throughput_pct = float(throughput_pct)
+    latency_pct = float(latency_pct)
+
+    print("| Benchmark | Mean latency | Δ latency | Throughput (ops/s) | Δ throughput | |")
+    print("|---|---:|---:|---:|---:|---|")
+    regressions = 0
+    for name in sorted(current):
+        cur = current[name]
+        prev = previous.get(name)
+        if prev is None:
+            print("| `%s` | %.3g s | | %.4g | | new |" % (name, cur["mean"], cur["ops"]))
+            continue
+        d_latency = change(cur["mean"], prev["mean"])
+        d_throughput = change(cur["ops"], prev["ops"])
+        regressed = d_latency > latency_pct or d_throughput < -throughput_pct
+        regressions += regressed
+        print("| `%s` | %.3g s | %+.1f%% | %.4g | %+.1f%% | %s |" % (
+            name, cur["mean"], d_latency, cur["ops"], d_throughput,
+            "❌ regression" if regressed else "✅"))
+    for name in sorted(set(previous) - set(current)):
+        print("| `%s` | | | | | removed |" % name)
+
+    print()
+    if not previous:
+        print("No previous results to compare against.")
+    elif regressions:
+        print("**%d benchmark(s) exceeded the throughput (-%g%%) or latency (+%g%%) threshold.**"
+              % (regressions, throughput_pct, latency_pct))
+    else:
+        print("All benchmarks within the throughput (-%g%%) and latency (+%g%%) thresholds."
+              % (throughput_pct, latency_pct))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(*sys.argv[1:]))
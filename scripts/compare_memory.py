@@ -0,0 +1,75 @@
+"""Compare two memory profiles and report growth.
+
+Usage: compare_memory.py <current.json> <previous.json|-> <growth-pct>
+
+Prints a markdown report with the top allocation sites of every benchmark.
+Exits with status 1 when the peak RSS, peak heap or allocation count of any
+benchmark grew by more than <growth-pct> percent against the previous
+results.
+"""
+import json
+import sys
+
+METRICS = (("peak_rss", "Peak RSS"), ("peak_heap", "Peak heap"), ("allocations", "Allocations"))
+
+
+def load(path):
+    if path == "-":
+        return {}
+    with open(path) as f:
+        return json.load(f)["benchmarks"]
+
+
+def fmt(metric, value):
+    if value is None:
+        return "n/a"
+    if metric == "allocations":
+        return "{:,}".format(value)
+    return "%.1f MiB" % (value / float(1 << 20))
+
+
+def main(current_path, previous_path, growth_pct):
+    current = load(current_path)
+    previous = load(previous_path)
+    growth_pct = float(growth_pct)
+
+    print("| Benchmark | " + " | ".join("%s | Δ" % label for _, label in METRICS) + " | |")
+    print("|---|" + "---:|---:|" * len(METRICS) + "---|")
+    regressions = 0
+    for name in sorted(current):
+        cur = current[name]
+        prev = previous.get(name, {})
+        cells = []
+        grew = False
+        for metric, _ in METRICS:
+            cells.append(fmt(metric, cur[metric]))
+            if cur[metric] is None or not prev.get(metric):
+                cells.append("")
+                continue
+            delta = (cur[metric] - prev[metric]) / prev[metric] * 100.0
+            grew = grew or delta > growth_pct
+            cells.append("%+.1f%%" % delta)
+        regressions += grew
+        status = "new" if name not in previous else ("❌ growth" if grew else "✅")
+        print("| `%s` | %s | %s |" % (name, " | ".join(cells), status))
+
+    print()
+    print("### Top allocation sites")
+    for name in sorted(current):
+        print()
+        print("`%s`" % name)
+        for spot in current[name]["hot_spots"]:
+            print("- {:,} calls: `{}`".format(spot["calls"], spot["function"]))
+
+    print()
+    if not previous:
+        print("No previous results to compare against.")
+    elif regressions:
+        print("**%d benchmark(s) grew by more than %g%%.**" % (regressions, growth_pct))
+    else:
+        print("No benchmark grew by more than %g%%." % growth_pct)
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(*sys.argv[1:]))
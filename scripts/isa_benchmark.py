@@ -0,0 +1,96 @@
+"""Benchmark each ISA build in an installed wheel against its baseline build.
+
+Usage: isa_benchmark.py <wheel> <benchmark-path> <out-dir> <rounds> <isa>...
+
+For baseline and every <isa>, first imports the wheel's dispatched
+extension modules with RETRACE_ISA set and logs the dispatcher's SELECTED
+map. An ISA whose build did not load on this CPU (the dispatcher fell back)
+is reported and left out rather than benchmarked as the baseline under
+another name. The remaining builds are then benchmarked with
+run_benchmarks.py in <rounds> interleaved rounds, so drift on the runner
+hits every build alike, and the per-benchmark median of the rounds is
+written to <out-dir>/<isa>.json.
+"""
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import zipfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+SELECTED = """\
+import importlib, json, sys
+for name in sys.argv[2:]:
+    importlib.import_module(name)
+print(json.dumps(importlib.import_module(sys.argv[1]).SELECTED))
+"""
+
+
+def dispatched_modules(wheel):
+    """Names of the extension modules the wheel loads through the dispatcher."""
+    names = []
+    with zipfile.ZipFile(wheel) as zf:
+        for name in zf.namelist():
+            stem, dot, rest = os.path.basename(name).partition(".baseline")
+            if dot and rest.endswith((".so", ".pyd")):
+                names.append((os.path.dirname(name) + "/" + stem).lstrip("/").replace("/", "."))
+    return names
+
+
+def loaded(hook, modules, isa):
+    out = subprocess.run(
+        [sys.executable, "-c", SELECTED, hook] + modules,
+        env=dict(os.environ, RETRACE_ISA=isa), capture_output=True, text=True, check=True,
+    ).stdout
+    selected = json.loads(out)
+    print("RETRACE_ISA=%s loaded %s" % (isa, selected))
+    return all(value == isa for value in selected.values())
+
+
+def median_results(runs):
+    merged = {}
+    for name in set().union(*runs):
+        stats = [run[name] for run in runs if name in run]
+        merged[name] = {key: statistics.median(s[key] for s in stats)
+                        for key in ("mean", "stddev", "ops")}
+        merged[name]["rounds"] = sum(s["rounds"] for s in stats)
+    return merged
+
+
+def main(wheel, path, out_dir, rounds, *isas):
+    modules = dispatched_modules(wheel)
+    if not modules:
+        sys.exit("%s has no ISA builds to benchmark" % wheel)
+    hook = "_%s_isa" % os.path.basename(wheel).split("-")[0]
+
+    builds = ["baseline"]
+    for isa in isas:
+        if loaded(hook, modules, isa):
+            builds.append(isa)
+        else:
+            print("::warning::this CPU cannot load the %s build, not benchmarking it" % isa)
+    loaded(hook, modules, "baseline")
+
+    results = {isa: [] for isa in builds}
+    with tempfile.TemporaryDirectory() as tmp:
+        for _ in range(int(rounds)):
+            for isa in builds:
+                report = os.path.join(tmp, isa + ".json")
+                subprocess.run(
+                    [sys.executable, os.path.join(HERE, "run_benchmarks.py"), path, report],
+                    env=dict(os.environ, RETRACE_ISA=isa), check=True,
+                )
+                with open(report) as f:
+                    results[isa].append(json.load(f)["benchmarks"])
+
+    os.makedirs(out_dir, exist_ok=True)
+    for isa, runs in results.items():
+        with open(os.path.join(out_dir, isa + ".json"), "w") as f:
+            json.dump({"benchmarks": median_results(runs)}, f, indent=2, sort_keys=True)
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
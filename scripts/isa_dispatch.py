@@ -0,0 +1,71 @@
+"""Load the best ISA build of an extension module.
+
+Shipped by the shared wheel builder. Every extension module with ISA
+variants is replaced by a stub of the same name that calls load(); the
+builds sit next to it as <stem>.<tag><suffix> and <stem>.baseline<suffix>.
+Nothing here runs until one of those modules is imported. Set
+RETRACE_ISA=baseline to force the baseline build, or to a variant name to
+prefer that variant.
+"""
+import os
+import sys
+from importlib.machinery import ExtensionFileLoader
+from importlib.util import module_from_spec, spec_from_file_location
+
+# Module name -> variant actually loaded, for diagnostics
+SELECTED = {}
+
+_X86_64_V2 = ("cx16", "lahf_lm", "popcnt", "sse4_1", "sse4_2", "ssse3")
+_X86_64_V3 = _X86_64_V2 + ("abm", "avx", "avx2", "bmi1", "bmi2", "f16c", "fma", "movbe", "xsave")
+_X86_64_V4 = _X86_64_V3 + ("avx512f", "avx512bw", "avx512cd", "avx512dq", "avx512vl")
+_ARMV8_2_A = ("asimdrdm", "atomics", "crc32")
+
+# Variant -> /proc/cpuinfo flags it needs, best variant first
+_REQUIRES = (
+    ("x86-64-v4", _X86_64_V4),
+    ("x86-64-v3", _X86_64_V3),
+    ("armv8.2-a", _ARMV8_2_A),
+)
+
+_supported = None
+
+
+def _cpu_flags():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                key, _, value = line.partition(":")
+                if key.strip() in ("flags", "Features"):
+                    return set(value.split())
+    except OSError:
+        pass
+    return set()
+
+
+def _supported_isas():
+    forced = os.environ.get("RETRACE_ISA", "")
+    if forced == "baseline":
+        return []
+    flags = _cpu_flags()
+    isas = [isa for isa, needs in _REQUIRES if flags.issuperset(needs)]
+    if forced in isas:
+        isas.remove(forced)
+        isas.insert(0, forced)
+    return isas
+
+
+def load(name, stub, builds):
+    """Replace the stub module `name` with the best of builds ({variant: file name})."""
+    global _supported
+    if _supported is None:
+        _supported = _supported_isas()
+    isa = next((isa for isa in _supported if isa in builds), "baseline")
+    path = os.path.join(os.path.dirname(stub), builds[isa])
+    loader = ExtensionFileLoader(name, path)
+    module = module_from_spec(spec_from_file_location(name, path, loader=loader))
+    # The import system hands out whatever sits in sys.modules once the stub
+    # has run, so importers get the extension module itself
+    sys.modules[name] = module
+    loader.exec_module(module)
+    SELECTED[name] = isa
+    return module
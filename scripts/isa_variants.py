@@ -0,0 +1,99 @@
+"""Add ISA-specific builds of the extension modules to a built wheel.
+
+Usage: isa_variants.py <project> <wheel> <variant>[,<variant>...] [setup-args...]
+
+Rebuilds the project once for every listed variant that applies to this
+machine and stores each extension module of that build as
+<stem>.<tag><suffix>; the baseline build is renamed to
+<stem>.baseline<suffix>. In its place goes a <stem>.py stub that loads the
+best copy the host CPU supports through isa_dispatch.py, so nothing runs
+until the module is imported. The wheel is rewritten in place, before it is
+repaired.
+"""
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import zipfile
+
+from wheel_files import rewrite_wheel, split_ext
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+_X86_64_V2 = "-mcx16 -msahf -mpopcnt -msse4.1 -msse4.2 -mssse3"
+_X86_64_V3 = _X86_64_V2 + " -mavx -mavx2 -mbmi -mbmi2 -mf16c -mfma -mlzcnt -mmovbe -mxsave"
+_X86_64_V4 = _X86_64_V3 + " -mavx512f -mavx512bw -mavx512cd -mavx512dq -mavx512vl"
+
+# Variant -> (machine, compiler flags). The feature flags are spelled out
+# rather than using -march=x86-64-vN, which GCC 10 in manylinux2014 lacks.
+# armv8.2-a (Graviton2 and later) inlines LSE atomics instead of calling
+# the libgcc helpers GCC 10 and later emits for them by default on aarch64.
+ISAS = {
+    "x86-64-v3": ("x86_64", _X86_64_V3),
+    "x86-64-v4": ("x86_64", _X86_64_V4),
+    "armv8.2-a": ("aarch64", "-march=armv8.2-a"),
+}
+
+STUB = """\
+# Generated by the shared wheel builder: loads the ISA build of this
+# extension module that suits the CPU, see {hook}.py.
+import {hook}
+
+{hook}.load(__name__, __file__, {builds!r})
+"""
+
+
+def tag(isa):
+    return re.sub(r"\W", "_", isa)
+
+
+def build_variant(project, isa, setup_args, outdir):
+    env = dict(os.environ)
+    for var in ("CFLAGS", "CXXFLAGS"):
+        env[var] = (env.get(var, "") + " " + ISAS[isa][1]).strip()
+    cmd = [sys.executable, "-m", "pip", "wheel", project, "--no-deps", "-w", outdir]
+    cmd += ["-Csetup-args=" + arg for arg in setup_args]
+    subprocess.run(cmd, check=True, env=env)
+    (built,) = [f for f in os.listdir(outdir) if f.endswith(".whl")]
+    return os.path.join(outdir, built)
+
+
+def main(project, wheel, variants, *setup_args):
+    requested = [isa for isa in variants.split(",") if isa]
+    unknown = [isa for isa in requested if isa not in ISAS]
+    if unknown:
+        sys.exit("unsupported ISA variant(s): " + ", ".join(unknown))
+    isas = [isa for isa in requested if ISAS[isa][0] == platform.machine()]
+    if not isas:
+        return
+
+    with zipfile.ZipFile(wheel) as zf:
+        modules = {name: split_ext(name) for name in zf.namelist() if split_ext(name)}
+    if not modules:
+        print("no extension modules in %s, skipping ISA variants" % wheel)
+        return
+
+    extra = {}
+    builds = {name: {"baseline": "%s.baseline%s" % (os.path.basename(stem), suffix)}
+              for name, (stem, suffix) in modules.items()}
+    with tempfile.TemporaryDirectory() as tmp:
+        for isa in isas:
+            built = build_variant(project, isa, setup_args, os.path.join(tmp, tag(isa)))
+            with zipfile.ZipFile(built) as zf:
+                for name, (stem, suffix) in modules.items():
+                    extra["%s.%s%s" % (stem, tag(isa), suffix)] = zf.read(name)
+                    builds[name][isa] = "%s.%s%s" % (os.path.basename(stem), tag(isa), suffix)
+
+    hook = "_%s_isa" % os.path.basename(wheel).split("-")[0]
+    with open(os.path.join(HERE, "isa_dispatch.py"), "rb") as f:
+        extra[hook + ".py"] = f.read()
+    with zipfile.ZipFile(wheel) as zf:
+        for name, (stem, suffix) in modules.items():
+            extra["%s.baseline%s" % (stem, suffix)] = zf.read(name)
+            extra[stem + ".py"] = STUB.format(hook=hook, builds=builds[name]).encode()
+    rewrite_wheel(wheel, extra, remove=modules)
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,88 @@
+"""Measure peak RSS, heap and allocation counts for each benchmark.
+
+Usage: memory_profile.py <benchmark-path> <output.json>
+
+The benchmarks are the pytest-benchmark tests in <benchmark-path>, each
+run once with --benchmark-disable so allocation counts do not depend on
+calibration, and the meson benchmark targets of the editable build. If
+there are neither, the test suite is measured as a single workload. Peak
+RSS comes from a plain run of the benchmark. Heap figures and the top
+allocation sites come from a second run under heaptrack.
+"""
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+from workloads import workloads
+
+HOT_SPOTS = 5
+
+UNITS = {"": 1, "K": 1 << 10, "M": 1 << 20, "G": 1 << 30, "T": 1 << 40}
+
+
+def size(text):
+    match = re.match(r"([\d.]+)\s*([KMGT]?)i?B?$", text.strip())
+    return int(float(match.group(1)) * UNITS[match.group(2)]) if match else None
+
+
+def peak_rss(cmd, cwd, env):
+    proc = subprocess.Popen(cmd, cwd=cwd, env=env, stdout=subprocess.DEVNULL)
+    # wait4 gives the usage of this child alone; ru_maxrss is in KiB
+    _, status, usage = os.wait4(proc.pid, 0)
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    if proc.returncode:
+        sys.exit("%s exited with status %d" % (" ".join(cmd), proc.returncode))
+    return usage.ru_maxrss * 1024
+
+
+def heaptrack(cmd, cwd, env, tmp):
+    data = os.path.join(tmp, "heaptrack")
+    subprocess.run(["heaptrack", "-o", data, "--"] + cmd, cwd=cwd, env=env,
+                   stdout=subprocess.DEVNULL, check=True)
+    (recorded,) = glob.glob(data + ".*")
+    text = subprocess.run(["heaptrack_print", "-f", recorded], capture_output=True,
+                          text=True, check=True).stdout
+
+    result = {"allocations": None, "temporary_allocations": None,
+              "peak_heap": None, "leaked": None, "hot_spots": []}
+    for key, pattern in (
+        ("allocations", r"^calls to allocation functions: (\d+)"),
+        ("temporary_allocations", r"^temporary memory allocations: (\d+)"),
+    ):
+        match = re.search(pattern, text, re.M)
+        if match:
+            result[key] = int(match.group(1))
+    for key, pattern in (
+        ("peak_heap", r"^peak heap memory consumption: (\S+)"),
+        ("leaked", r"^total memory leaked: (\S+)"),
+    ):
+        match = re.search(pattern, text, re.M)
+        if match:
+            result[key] = size(match.group(1))
+
+    section = text.split("MOST CALLS TO ALLOCATION FUNCTIONS", 1)[-1]
+    lines = section.splitlines()
+    for i, line in enumerate(lines):
+        match = re.match(r"^(\d+) calls to allocation functions with .* from$", line)
+        if match and i + 1 < len(lines):
+            result["hot_spots"].append({"calls": int(match.group(1)), "function": lines[i + 1].strip()})
+            if len(result["hot_spots"]) == HOT_SPOTS:
+                break
+    return result
+
+
+def main(path, output):
+    results = {}
+    for name, cmd, cwd, env in workloads(path):
+        with tempfile.TemporaryDirectory() as tmp:
+            results[name] = dict(heaptrack(cmd, cwd, env, tmp), peak_rss=peak_rss(cmd, cwd, env))
+    with open(output, "w") as f:
+        json.dump({"benchmarks": results}, f, indent=2, sort_keys=True)
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,110 @@
+"""Run each benchmark under `perf stat` and report its hardware counters.
+
+Usage: perf_stat.py <benchmark-path> <output-stem>
+
+The benchmarks are the pytest-benchmark tests in <benchmark-path>, each
+run for one round with --benchmark-disable so the counts do not depend on
+calibration, and the meson benchmark targets of the editable build. If
+there are neither, the test suite is measured as a single workload. Each
+pytest workload is also run with --collect-only, which pays for the
+interpreter, pytest and the imports but not the test body, and that
+baseline is subtracted so the counts are those of one round. Every run is
+repeated and the median taken. Writes <output-stem>.json and a markdown
+table to <output-stem>.md. Counters that the runner's virtualized PMU does
+not expose are reported as null.
+"""
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+from workloads import workloads
+
+EVENTS = ["instructions", "cycles", "cache-misses", "branch-misses", "page-faults"]
+REPEAT = 3
+
+
+def perf_stat_once(cmd, cwd, env):
+    counters = dict.fromkeys(EVENTS)
+    with tempfile.TemporaryDirectory() as tmp:
+        report = os.path.join(tmp, "perf-stat.csv")
+        proc = subprocess.run(
+            ["perf", "stat", "-x", ",", "-e", ",".join(EVENTS), "-o", report, "--"] + cmd,
+            cwd=cwd, env=env, stdout=subprocess.DEVNULL,
+        )
+        if proc.returncode:
+            sys.exit("%s exited with status %d" % (" ".join(cmd), proc.returncode))
+        with open(report) as f:
+            for line in f:
+                fields = line.strip().split(",")
+                if line.startswith("#") or len(fields) < 3:
+                    continue
+                event = fields[2].split(":")[0]
+                if event in counters:
+                    try:
+                        counters[event] = int(float(fields[0]))
+                    except ValueError:
+                        pass  # <not supported> or <not counted>
+    return counters
+
+
+def perf_stat(cmd, cwd, env):
+    runs = [perf_stat_once(cmd, cwd, env) for _ in range(REPEAT)]
+    counters = {}
+    for event in EVENTS:
+        values = sorted(run[event] for run in runs if run[event] is not None)
+        counters[event] = values[len(values) // 2] if len(values) == REPEAT else None
+    return counters
+
+
+def baseline_cmd(cmd):
+    # Startup, imports and collection, without running the test body
+    if cmd[1:3] == ["-m", "pytest"]:
+        return cmd + ["--collect-only"]
+    return None
+
+
+def net(counters, baseline):
+    result = {}
+    for event in EVENTS:
+        value = counters[event]
+        if value is not None and baseline is not None:
+            value = None if baseline[event] is None else value - baseline[event]
+        result[event] = value
+    if result["instructions"] is not None and (result["cycles"] or 0) > 0:
+        result["ipc"] = result["instructions"] / result["cycles"]
+    else:
+        result["ipc"] = None
+    return result
+
+
+def cell(value, fmt="{:,}"):
+    return "n/a" if value is None else fmt.format(value)
+
+
+def main(path, stem):
+    results = {}
+    baselines = {}
+    for name, cmd, cwd, env in workloads(path):
+        base = baseline_cmd(cmd)
+        baselines[name] = base and perf_stat(base, cwd, env)
+        results[name] = net(perf_stat(cmd, cwd, env), baselines[name])
+
+    with open(stem + ".json", "w") as f:
+        json.dump({"events": EVENTS, "benchmarks": results, "baselines": baselines},
+                  f, indent=2, sort_keys=True)
+
+    with open(stem + ".md", "w") as f:
+        f.write("Counts for one round of each benchmark; pytest benchmarks are "
+                "less a `--collect-only` run of the same test.\n\n")
+        f.write("| Benchmark | Instructions | Cycles | IPC | Cache misses | Branch misses | Page faults |\n")
+        f.write("|---|---:|---:|---:|---:|---:|---:|\n")
+        for name, c in sorted(results.items()):
+            f.write("| `%s` | %s | %s | %s | %s | %s | %s |\n" % (
+                name, cell(c["instructions"]), cell(c["cycles"]), cell(c["ipc"], "{:.2f}"),
+                cell(c["cache-misses"]), cell(c["branch-misses"]), cell(c["page-faults"])))
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
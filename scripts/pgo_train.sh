@@ -0,0 +1,45 @@
+# Runs inside the cibuildwheel environment (the container on Linux) before
+# each wheel build: builds an instrumented copy of the extension into
+# <build-dir>, runs the training workload against it and leaves the profile
+# in <build-dir> for the -Db_pgo=use rebuild.
+# Usage: pgo_train.sh <project> <build-dir> [setup-args...]
+set -eu
+PROJECT=$1
+BUILD_DIR=$2
+shift 2
+
+SETUP_ARGS=""
+for arg in "$@"; do
+  SETUP_ARGS="$SETUP_ARGS -Csetup-args=$arg"
+done
+
+SITE="$BUILD_DIR-site"
+rm -rf "$BUILD_DIR" "$SITE"
+mkdir -p "$BUILD_DIR"
+
+# GCC drops .gcda files next to the objects; clang needs a path
+export LLVM_PROFILE_FILE="$BUILD_DIR/pgo-%p-%m.profraw"
+
+python -m pip install "$PROJECT" --no-deps --target "$SITE" \
+  -Cbuild-dir="$BUILD_DIR" -Csetup-args=-Db_pgo=generate $SETUP_ARGS
+python -m pip install pytest
+
+# A failing workload would leave a profile of whatever ran before it
+if ! (cd "$PROJECT" && PYTHONPATH="$SITE" sh .retrace-ci/profile_workload.sh); then
+  echo "error: PGO training workload failed" >&2
+  exit 1
+fi
+
+if [ -z "$(find "$BUILD_DIR" -name '*.gcda' -o -name '*.profraw' | head -n 1)" ]; then
+  echo "error: PGO training workload left no profile in $BUILD_DIR" >&2
+  exit 1
+fi
+
+if ls "$BUILD_DIR"/*.profraw >/dev/null 2>&1; then
+  if command -v xcrun >/dev/null 2>&1; then
+    xcrun llvm-profdata merge -o "$BUILD_DIR/default.profdata" "$BUILD_DIR"/*.profraw
+  else
+    llvm-profdata merge -o "$BUILD_DIR/default.profdata" "$BUILD_DIR"/*.profraw
+  fi
+fi
+rm -rf "$SITE"
@@ -0,0 +1,33 @@
+"""Print the wheel in <dir> that this interpreter would pick, as pip would.
+
+Usage: pick_wheel.py <dir>
+
+An artifact may hold wheels for several interpreters and platforms. The
+wheel with the most specific tag this interpreter supports wins, so the
+install does not depend on pip's index lookup and cannot fall back to a
+release of the same version from PyPI.
+"""
+import glob
+import os
+import sys
+
+from packaging.tags import sys_tags
+from packaging.utils import parse_wheel_filename
+
+
+def main(path):
+    # sys_tags() lists the most specific tags first
+    priority = {tag: rank for rank, tag in enumerate(sys_tags())}
+    best = None
+    for wheel in glob.glob(os.path.join(path, "*.whl")):
+        tags = parse_wheel_filename(os.path.basename(wheel))[3]
+        rank = min((priority[tag] for tag in tags if tag in priority), default=None)
+        if rank is not None and (best is None or rank < best[0]):
+            best = (rank, wheel)
+    if best is None:
+        sys.exit("no wheel in %s supports this interpreter" % path)
+    print(best[1])
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
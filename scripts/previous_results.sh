@@ -0,0 +1,48 @@
+# Fetches the results of the tag before the one being benchmarked into
+# previous/<results>, for the comparison gates. Takes the asset attached to
+# that release if there is one; otherwise builds the tag in a worktree and
+# runs <command...> there with the output path appended. A previous tag that
+# cannot be built just leaves nothing to compare.
+# Usage: previous_results.sh <results> <command...>
+# Writes the tag to the step output 'tag'; needs GH_TOKEN and SETUP_ARGS.
+set -eu
+RESULTS=$1
+shift
+
+# When benchmarking a tag, compare against the one before it
+if git describe --tags --exact-match HEAD >/dev/null 2>&1; then
+  BASE=HEAD^
+else
+  BASE=HEAD
+fi
+PREVIOUS=$(git describe --tags --abbrev=0 "$BASE" 2>/dev/null || true)
+echo "tag=$PREVIOUS" >> "$GITHUB_OUTPUT"
+echo "Previous tag: ${PREVIOUS:-none}"
+[ -n "$PREVIOUS" ] || exit 0
+
+mkdir -p previous
+if gh release download "$PREVIOUS" --pattern "$RESULTS" --dir previous; then
+  exit 0
+fi
+
+echo "No stored results for $PREVIOUS, benchmarking it on this runner"
+OUT="$PWD/previous/$RESULTS"
+set +e
+(
+  set -e
+  git worktree add "$RUNNER_TEMP/previous" "$PREVIOUS"
+  cd "$RUNNER_TEMP/previous"
+  git submodule update --init --recursive
+  if [ -n "$SETUP_ARGS" ]; then
+    mkdir -p subprojects
+    cp -rn "$GITHUB_WORKSPACE/subprojects/." subprojects/
+  fi
+  pip install -e . --no-build-isolation $SETUP_ARGS
+  "$@" "$OUT"
+)
+STATUS=$?
+set -e
+if [ $STATUS -ne 0 ]; then
+  echo "::warning::Could not benchmark $PREVIOUS, nothing to compare against"
+  rm -f "$OUT"
+fi
@@ -0,0 +1,145 @@
+"""Measure end-to-end record and replay throughput on a fixed workload.
+
+Usage: record_replay_bench.py <record-command> <replay-command> <scale> <runs> <results>
+
+Runs rr_workload.py untraced, under <record-command> and then replays the
+trace with <replay-command>, <runs> times each, and takes the median wall
+time. The commands are run by the shell after substituting {python} (this
+interpreter), {workload} (the workload script and its arguments) and
+{trace} (where the recording goes; a file or a directory). The echo server
+is up for the live and recorded runs and shut down before replaying, so a
+replay cannot reach the network. Writes <results>.json and <results>.md.
+
+Event rates use the number of OS calls the workload is written to make
+(rr_workload.events), not a count taken from the trace, so they are
+nominal: a recorder that captures more or fewer events is not credited.
+"""
+import json
+import os
+import platform
+import shlex
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, HERE)
+
+from rr_workload import events  # noqa: E402
+
+
+def start_server(workdir):
+    port_file = os.path.join(workdir, "port")
+    server = subprocess.Popen([sys.executable, os.path.join(HERE, "rr_echo_server.py"), port_file])
+    deadline = time.monotonic() + 30
+    while not os.path.exists(port_file):
+        if server.poll() is not None or time.monotonic() > deadline:
+            server.kill()
+            sys.exit("echo server did not start")
+        time.sleep(0.05)
+    with open(port_file) as f:
+        return server, int(f.read())
+
+
+def size_of(path):
+    if os.path.isfile(path):
+        return os.path.getsize(path)
+    total = 0
+    for root, _, files in os.walk(path):
+        total += sum(os.path.getsize(os.path.join(root, name)) for name in files)
+    return total
+
+
+def remove(path):
+    if os.path.isdir(path):
+        shutil.rmtree(path)
+    elif os.path.exists(path):
+        os.remove(path)
+
+
+def timed(label, command, cwd):
+    print("::group::%s: %s" % (label, command), flush=True)
+    start = time.perf_counter()
+    proc = subprocess.run(command, shell=True, cwd=cwd)
+    elapsed = time.perf_counter() - start
+    print("::endgroup::", flush=True)
+    if proc.returncode != 0:
+        sys.exit("%s failed with exit status %d" % (label, proc.returncode))
+    return elapsed
+
+
+def main(record_command, replay_command, scale, runs, results):
+    scale, runs = int(scale), int(runs)
+    workdir = tempfile.mkdtemp(prefix="record-replay-")
+    trace = os.path.join(workdir, "trace")
+    server, port = start_server(workdir)
+    fields = {
+        "python": shlex.quote(sys.executable),
+        "workload": " ".join(shlex.quote(arg) for arg in
+                             (os.path.join(HERE, "rr_workload.py"), str(scale), workdir, str(port))),
+        "trace": shlex.quote(trace),
+    }
+    live_command = "{python} {workload}".format(**fields)
+    try:
+        live = [timed("live", live_command, workdir) for _ in range(runs)]
+        record = []
+        for _ in range(runs):
+            remove(trace)
+            record.append(timed("record", record_command.format(**fields), workdir))
+    finally:
+        server.terminate()
+        server.wait()
+    if not os.path.exists(trace):
+        sys.exit("record command did not write %s" % trace)
+    trace_bytes = size_of(trace)
+    replay = [timed("replay", replay_command.format(**fields), workdir) for _ in range(runs)]
+
+    live_s, record_s, replay_s = (statistics.median(t) for t in (live, record, replay))
+    count = events(scale)
+    data = {
+        "machine": platform.machine(),
+        "python": platform.python_version(),
+        "scale": scale,
+        "runs": runs,
+        "workload_events": count,
+        "trace_bytes": trace_bytes,
+        "live_s": live_s,
+        "record_s": record_s,
+        "replay_s": replay_s,
+        "workload_events_per_s": count / record_s,
+        "trace_bytes_per_s": trace_bytes / record_s,
+        "record_slowdown": record_s / live_s,
+        "replay_speed": live_s / replay_s,
+    }
+    with open(results + ".json", "w") as f:
+        json.dump(data, f, indent=2, sort_keys=True)
+
+    lines = [
+        "## Record/replay throughput (%s, Python %s)" % (data["machine"], data["python"]),
+        "",
+        "Median of %d runs. The workload makes %d OS calls per run; event rates "
+        "are that nominal count over the recorded time, not counted from the trace."
+        % (runs, count),
+        "",
+        "| Metric | Value |",
+        "|---|---:|",
+        "| Untraced run | %.3f s |" % live_s,
+        "| Recorded run | %.3f s |" % record_s,
+        "| Replay | %.3f s |" % replay_s,
+        "| Workload events per second while recording (nominal) | {:,.0f} |".format(
+            data["workload_events_per_s"]),
+        "| Trace size | {:,} bytes |".format(trace_bytes),
+        "| Trace bytes written per second | %.1f MiB/s |" % (data["trace_bytes_per_s"] / float(1 << 20)),
+        "| Recording slowdown vs untraced | %.2fx |" % data["record_slowdown"],
+        "| Replay speed vs live | %.2fx |" % data["replay_speed"],
+    ]
+    with open(results + ".md", "w") as f:
+        f.write("\n".join(lines) + "\n")
+    shutil.rmtree(workdir, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
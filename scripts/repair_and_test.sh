@@ -0,0 +1,24 @@
+# Repairs the unrepaired wheels in <in-dir> into <out-dir> and runs the wheel
+# tests against every repaired wheel, the way cibuildwheel does in its
+# container. Runs in the manylinux image with the project mounted at
+# /project, for wheels that were post-processed on the runner.
+# Usage: repair_and_test.sh <in-dir> <out-dir>
+# TEST_REQUIRES and TEST_COMMAND are the cibuildwheel test settings.
+set -eu
+IN_DIR=$1
+OUT_DIR=$2
+
+for wheel in "$IN_DIR"/*.whl; do
+  [ -e "$wheel" ] || continue
+  name=$(basename "$wheel")
+  auditwheel repair -w "$OUT_DIR" "$wheel"
+  repaired=$(ls "$OUT_DIR/$(echo "$name" | cut -d- -f1-4)"-manylinux*.whl)
+
+  # cp313-cp313t wheels are tested with /opt/python/cp313-cp313t
+  venv=$(mktemp -d)
+  "/opt/python/$(echo "$name" | cut -d- -f3-4)/bin/python" -m venv "$venv"
+  "$venv/bin/pip" install "$repaired" $TEST_REQUIRES
+  # Away from the checkout, so the installed wheel is what gets imported
+  (cd "$venv" && PATH="$venv/bin:$PATH" sh -c "$(echo "$TEST_COMMAND" | sed 's#{project}#/project#g')")
+  rm -rf "$venv"
+done
@@ -0,0 +1,39 @@
+"""Local echo server standing in for a network service.
+
+Usage: rr_echo_server.py <port-file>
+
+Listens on an ephemeral port on 127.0.0.1, writes the port number to
+<port-file> once it accepts connections, and echoes everything it receives
+until it is terminated. It runs as its own process, outside the recorder.
+"""
+import os
+import socket
+import socketserver
+import sys
+
+
+class Echo(socketserver.BaseRequestHandler):
+    def handle(self):
+        self.request.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        while True:
+            data = self.request.recv(65536)
+            if not data:
+                return
+            self.request.sendall(data)
+
+
+class Server(socketserver.ThreadingTCPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+def main(port_file):
+    with Server(("127.0.0.1", 0), Echo) as server:
+        with open(port_file + ".tmp", "w") as f:
+            f.write(str(server.server_address[1]))
+        os.replace(port_file + ".tmp", port_file)
+        server.serve_forever()
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,83 @@
+"""Fixed synthetic workload for the record/replay benchmark.
+
+Usage: rr_workload.py <scale> <workdir> <port>
+
+Runs the same sequence every time: a CPU-bound loop, many small unbuffered
+file writes and reads in <workdir>, clock reads, and request/response round
+trips with the echo server on 127.0.0.1:<port>. events(scale) is the number
+of calls crossing into the OS that a recorder has to capture.
+"""
+import hashlib
+import os
+import socket
+import sys
+import time
+
+CPU_ITERATIONS = 200000
+FILE_CALLS = 5000
+CLOCK_CALLS = 10000
+ROUND_TRIPS = 2000
+CHUNK = 64
+
+
+def events(scale):
+    """Writes, reads, clock reads and one send plus one receive per round trip."""
+    return scale * (2 * FILE_CALLS + CLOCK_CALLS + 2 * ROUND_TRIPS)
+
+
+def cpu(scale):
+    acc = 0
+    for i in range(scale * CPU_ITERATIONS):
+        acc = (acc * 31 + i) % 1000003
+    return acc
+
+
+def file_io(scale, workdir):
+    path = os.path.join(workdir, "small_io.bin")
+    data = b"x" * CHUNK
+    fd = os.open(path, os.O_RDWR | os.O_CREAT | os.O_TRUNC, 0o644)
+    try:
+        for _ in range(scale * FILE_CALLS):
+            os.write(fd, data)
+        os.lseek(fd, 0, os.SEEK_SET)
+        digest = hashlib.sha1()
+        for _ in range(scale * FILE_CALLS):
+            digest.update(os.read(fd, CHUNK))
+    finally:
+        os.close(fd)
+    return digest.hexdigest()
+
+
+def clock(scale):
+    last = 0.0
+    for _ in range(scale * CLOCK_CALLS):
+        last = time.time()
+    return last
+
+
+def network(scale, port):
+    with socket.create_connection(("127.0.0.1", port)) as conn:
+        conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        for i in range(scale * ROUND_TRIPS):
+            request = (b"%08d" % i) * (CHUNK // 8)
+            conn.sendall(request)
+            reply = b""
+            while len(reply) < CHUNK:
+                part = conn.recv(CHUNK - len(reply))
+                if not part:
+                    raise RuntimeError("echo server closed the connection")
+                reply += part
+            if reply != request:
+                raise RuntimeError("echo server sent back %r for %r" % (reply, request))
+
+
+def main(scale, workdir, port):
+    scale = int(scale)
+    cpu(scale)
+    file_io(scale, workdir)
+    clock(scale)
+    network(scale, int(port))
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,90 @@
+"""Run the package's benchmarks and write normalized results as JSON.
+
+Usage: run_benchmarks.py <benchmark-path> <output.json>
+
+Collects pytest-benchmark results from <benchmark-path> (when it exists)
+and `meson test --benchmark` results from the editable build directory.
+Every benchmark is recorded with its mean latency in seconds and its
+throughput in operations per second.
+"""
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+MESON_REPEAT = 5
+
+
+def pytest_benchmarks(path):
+    if not os.path.isdir(path):
+        return {}
+    with tempfile.TemporaryDirectory() as tmp:
+        report = os.path.join(tmp, "pytest-benchmark.json")
+        proc = subprocess.run(
+            [sys.executable, "-m", "pytest", path, "-q", "--benchmark-only",
+             "--benchmark-json=" + report],
+        )
+        # Exit status 5 means nothing was collected
+        if proc.returncode not in (0, 5):
+            sys.exit("benchmark run failed")
+        if not os.path.exists(report):
+            return {}
+        with open(report) as f:
+            data = json.load(f)
+    return {
+        bench["fullname"]: {
+            "mean": bench["stats"]["mean"],
+            "stddev": bench["stats"]["stddev"],
+            "ops": bench["stats"]["ops"],
+            "rounds": bench["stats"]["rounds"],
+        }
+        for bench in data["benchmarks"]
+    }
+
+
+def meson_benchmarks():
+    durations = {}
+    for info in glob.glob("build/*/meson-info"):
+        build = os.path.dirname(info)
+        listed = subprocess.run(
+            ["meson", "test", "-C", build, "--benchmark", "--list"],
+            capture_output=True, text=True,
+        )
+        if listed.returncode != 0 or not listed.stdout.strip():
+            continue
+        subprocess.run(
+            ["meson", "test", "-C", build, "--benchmark", "--num-processes", "1",
+             "--repeat", str(MESON_REPEAT)],
+            check=True,
+        )
+        with open(os.path.join(build, "meson-logs", "testlog.json")) as f:
+            for line in f:
+                test = json.loads(line)
+                durations.setdefault("meson:" + test["name"], []).append(test["duration"])
+
+    results = {}
+    for name, runs in durations.items():
+        mean = sum(runs) / len(runs)
+        stddev = (sum((run - mean) ** 2 for run in runs) / len(runs)) ** 0.5
+        results[name] = {
+            "mean": mean,
+            "stddev": stddev,
+            "ops": 1.0 / mean if mean else 0.0,
+            "rounds": len(runs),
+        }
+    return results
+
+
+def main(path, output):
+    benchmarks = pytest_benchmarks(path)
+    benchmarks.update(meson_benchmarks())
+    if not benchmarks:
+        print("::warning::no benchmarks found (no %s/ and no meson benchmark targets)" % path)
+    with open(output, "w") as f:
+        json.dump({"benchmarks": benchmarks}, f, indent=2, sort_keys=True)
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
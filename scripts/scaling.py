@@ -0,0 +1,53 @@
+"""Measure how the test suite scales with threads on a free-threaded build.
+
+Usage: scaling.py <tests-path>
+
+Runs the tests in <tests-path> with every test on N threads at once
+(pytest-run-parallel) and the GIL forced off; perfect scaling keeps the
+wall time flat as N grows. Interpreter startup, imports and collection are
+paid once whatever N is, so the median of a few --collect-only runs is
+subtracted from every timing and only the time spent in the tests is
+compared. Prints a markdown table.
+"""
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import time
+
+BASELINE_RUNS = 3
+
+
+def timed(path, *args):
+    start = time.perf_counter()
+    subprocess.run(
+        [sys.executable, "-m", "pytest", path, "-q", "-p", "no:cacheprovider"] + list(args),
+        check=True, env=dict(os.environ, PYTHON_GIL="0"), stdout=subprocess.DEVNULL,
+    )
+    return time.perf_counter() - start
+
+
+def main(path):
+    cores = os.cpu_count() or 1
+    counts = sorted({1, 2, cores, 2 * cores} | {n for n in (4, 8) if n <= cores})
+    overhead = statistics.median(timed(path, "--collect-only") for _ in range(BASELINE_RUNS))
+
+    print("## Free-threaded scaling (%s, %d cores)" % (platform.machine(), cores))
+    print()
+    print("Test time excludes %.2f s of startup and collection per run." % overhead)
+    print()
+    print("| Threads | Test time | Speedup | Efficiency |")
+    print("|---:|---:|---:|---:|")
+    base = None
+    for threads in counts:
+        elapsed = max(timed(path, "--parallel-threads=%d" % threads) - overhead, 1e-6)
+        base = base or elapsed
+        # N threads do N times the work of one
+        speedup = threads * base / elapsed
+        print("| %d | %.2f s | %.2fx | %.0f%% |"
+              % (threads, elapsed, speedup, 100.0 * speedup / min(threads, cores)))
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,53 @@
+"""Move the debug info of a wheel's ELF files into separate .debug files.
+
+Usage: split_debug.py <wheel> <debug-dir>
+
+Every ELF file the project built (libraries grafted by auditwheel are left
+alone) is stripped of its debug sections and linked to its debug file with
+.gnu_debuglink. The debug info is written to <debug-dir>/<build-id>.debug,
+which is also the name of the release asset.
+"""
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import zipfile
+
+from wheel_files import rewrite_wheel
+
+
+def build_id(path):
+    notes = subprocess.run(["readelf", "-n", path], capture_output=True, text=True, check=True).stdout
+    match = re.search(r"Build ID: ([0-9a-f]+)", notes)
+    return match.group(1) if match else None
+
+
+def main(wheel, debug_dir):
+    os.makedirs(debug_dir, exist_ok=True)
+    stripped = {}
+    with zipfile.ZipFile(wheel) as zf, tempfile.TemporaryDirectory() as tmp:
+        for name in zf.namelist():
+            if ".libs/" in name or name.endswith("/"):
+                continue
+            data = zf.read(name)
+            if not data.startswith(b"\x7fELF"):
+                continue
+            path = os.path.join(tmp, os.path.basename(name))
+            with open(path, "wb") as f:
+                f.write(data)
+            bid = build_id(path)
+            if bid is None:
+                print("::warning::%s has no build-id, keeping its debug info" % name)
+                continue
+            debug = os.path.join(debug_dir, bid + ".debug")
+            subprocess.run(["objcopy", "--only-keep-debug", path, debug], check=True)
+            subprocess.run(["objcopy", "--strip-debug", "--add-gnu-debuglink=" + debug, path], check=True)
+            with open(path, "rb") as f:
+                stripped[name] = f.read()
+    if stripped:
+        rewrite_wheel(wheel, stripped)
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,102 @@
+"""Measure how long importing a package adds to interpreter startup.
+
+Usage: startup_bench.py <module> <cold-budget-ms> <warm-budget-ms> [runs]
+
+Every measurement is a fresh interpreter process, timed from spawn to
+exit, minus the median time of `python -c pass`. "Cold" imports start
+with the package's __pycache__ removed, like the first process after an
+install; "warm" imports reuse it, like every later worker spawn. Also
+reports the init time of the package's extension modules from
+-X importtime. Exits with status 1 when the median cold or warm cost is
+over budget.
+"""
+import importlib.util
+import json
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import time
+from importlib.machinery import EXTENSION_SUFFIXES
+
+
+def run(args):
+    # Bytecode has to be written for the warm runs to be warm
+    env = dict(os.environ)
+    env.pop("PYTHONDONTWRITEBYTECODE", None)
+    start = time.perf_counter()
+    proc = subprocess.run([sys.executable] + args, env=env, capture_output=True, text=True, check=True)
+    return time.perf_counter() - start, proc
+
+
+def clear_bytecode(module):
+    spec = importlib.util.find_spec(module.split(".")[0])
+    for location in spec.submodule_search_locations or []:
+        for root, dirs, _ in os.walk(location):
+            if "__pycache__" in dirs:
+                dirs.remove("__pycache__")
+                shutil.rmtree(os.path.join(root, "__pycache__"))
+
+
+def median_ms(args, runs, cold_module=None):
+    run(args)
+    times = []
+    for _ in range(runs):
+        if cold_module:
+            clear_bytecode(cold_module)
+        elapsed, _ = run(args)
+        times.append(elapsed * 1000.0)
+    return statistics.median(times)
+
+
+def extension_init_us(module):
+    """Self time of each of the package's extension modules, in microseconds."""
+    package = module.split(".")[0]
+    probe = (
+        "import json, sys, %s\n"
+        "print(json.dumps({n: getattr(m, '__file__', None) or '' for n, m in sys.modules.items()}))"
+        % module
+    )
+    run(["-c", probe])
+    _, proc = run(["-X", "importtime", "-c", probe])
+    files = json.loads(proc.stdout)
+    extensions = {
+        name for name, path in files.items()
+        if (name == package or name.startswith(package + "."))
+        and path.endswith(tuple(EXTENSION_SUFFIXES))
+    }
+    init = {}
+    for line in proc.stderr.splitlines():
+        match = re.match(r"import time:\s+(\d+) \|\s+\d+ \|\s*(\S+)", line)
+        if match and match.group(2) in extensions:
+            init[match.group(2)] = int(match.group(1))
+    return init
+
+
+def main(module, cold_budget_ms, warm_budget_ms, runs="10"):
+    cold_budget_ms = float(cold_budget_ms)
+    warm_budget_ms = float(warm_budget_ms)
+    runs = int(runs)
+
+    baseline = median_ms(["-c", "pass"], runs)
+    cold = median_ms(["-c", "import " + module], runs, cold_module=module) - baseline
+    warm = median_ms(["-c", "import " + module], runs) - baseline
+
+    print("Import cost of %s (median of %d, interpreter startup %.1f ms excluded)" % (module, runs, baseline))
+    print("  cold: %7.1f ms  (budget %g ms)" % (cold, cold_budget_ms))
+    print("  warm: %7.1f ms  (budget %g ms)" % (warm, warm_budget_ms))
+    for name, us in sorted(extension_init_us(module).items(), key=lambda item: -item[1]):
+        print("  init %s: %.1f ms" % (name, us / 1000.0))
+
+    over = [label for label, cost, budget in (("cold", cold, cold_budget_ms), ("warm", warm, warm_budget_ms))
+            if cost > budget]
+    if over:
+        print("import time over budget: " + ", ".join(over))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(*sys.argv[1:]))
@@ -0,0 +1,11 @@
+# Vendors the meson wrap of <allocator> into subprojects/, for packages that
+# link it for their own allocations through an 'allocator' option in
+# meson.options. A package without that option fails at setup with meson's
+# unknown-option error, so it is not checked here.
+# Usage: vendor_allocator.sh <allocator>
+set -eu
+ALLOCATOR=$1
+
+mkdir -p subprojects
+[ -f "subprojects/$ALLOCATOR.wrap" ] || meson wrap install "$ALLOCATOR"
+meson subprojects download "$ALLOCATOR"
@@ -0,0 +1,44 @@
+"""Helpers shared by the scripts that rewrite built wheels in place."""
+import base64
+import hashlib
+import zipfile
+from importlib.machinery import EXTENSION_SUFFIXES
+
+
+def split_ext(name):
+    """Split an extension module path into (stem, suffix), or return None."""
+    if ".data/" in name:
+        return None
+    # A bare ".so" also matches plain shared libraries, so require the ABI tag
+    for suffix in sorted(EXTENSION_SUFFIXES, key=len, reverse=True):
+        if suffix != ".so" and name.endswith(suffix):
+            return name[: -len(suffix)], suffix
+    return None
+
+
+def rewrite_wheel(wheel, files, remove=()):
+    """Add or replace files ({archive name: bytes}), drop `remove` and regenerate RECORD."""
+    with zipfile.ZipFile(wheel) as zf:
+        entries = {info.filename: (info, zf.read(info)) for info in zf.infolist() if not info.is_dir()}
+    record = next(name for name in entries if name.endswith(".dist-info/RECORD"))
+    del entries[record]
+    for name in remove:
+        del entries[name]
+    for name, data in sorted(files.items()):
+        if name in entries:
+            info = entries[name][0]
+        else:
+            info = zipfile.ZipInfo(name, date_time=(1980, 1, 1, 0, 0, 0))
+            info.external_attr = (0o755 if split_ext(name) else 0o644) << 16
+        entries[name] = (info, data)
+
+    lines = []
+    for name, (info, data) in entries.items():
+        digest = base64.urlsafe_b64encode(hashlib.sha256(data).digest()).rstrip(b"=").decode()
+        lines.append("%s,sha256=%s,%d" % (name, digest, len(data)))
+    lines.append(record + ",,")
+
+    with zipfile.ZipFile(wheel, "w") as zf:
+        for info, data in entries.values():
+            zf.writestr(info, data, compress_type=zipfile.ZIP_DEFLATED)
+        zf.writestr(record, "\n".join(lines) + "\n", compress_type=zipfile.ZIP_DEFLATED)
@@ -0,0 +1,44 @@
+"""Find the benchmarks to measure one process at a time.
+
+Shared by the scripts that wrap each benchmark in an external profiler.
+"""
+import glob
+import json
+import os
+import subprocess
+import sys
+
+
+def workloads(path, pytest_args=("--benchmark-disable",)):
+    """Return (name, command, cwd, env) for every benchmark to measure.
+
+    The benchmarks are the pytest-benchmark tests in <path>, each run on its
+    own with <pytest_args>, and the meson benchmark targets of the editable
+    build. If there are neither, the test suite is a single workload.
+    """
+    found = []
+    if os.path.isdir(path):
+        collected = subprocess.run(
+            [sys.executable, "-m", "pytest", path, "--collect-only", "-q"],
+            capture_output=True, text=True,
+        ).stdout
+        for line in collected.splitlines():
+            if "::" in line:
+                node = line.strip()
+                found.append((node, [sys.executable, "-m", "pytest", node, "-q"] + list(pytest_args), None, None))
+
+    for info in glob.glob("build/*/meson-info"):
+        build = os.path.dirname(info)
+        introspect = subprocess.run(
+            ["meson", "introspect", build, "--benchmarks"], capture_output=True, text=True,
+        )
+        if introspect.returncode:
+            continue
+        subprocess.run(["meson", "compile", "-C", build], check=True)
+        for bench in json.loads(introspect.stdout):
+            env = dict(os.environ, **bench.get("env", {}))
+            found.append(("meson:" + bench["name"], bench["cmd"], bench.get("workdir"), env))
+
+    if not found:
+        found.append(("tests", [sys.executable, "-m", "pytest", "tests", "-q"], None, None))
+    return found